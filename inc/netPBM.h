@@ -7,6 +7,8 @@
 #include <string>
 #include <algorithm>
 #include <fstream>
+#include <cstring>
+#include <vector>
 #ifndef __NETPBM__H__
 
 /** ***************************************************************************
@@ -37,6 +39,39 @@ struct image
     pixel **blue; /*!< a 2d array containing the blue pixel values */
 };
 
+/** ***************************************************************************
+ * @brief log2 of the edge length in pixels of the finest (64x64) tiles in the
+ * block summary pyramid
+ *****************************************************************************/
+const int BLOCK_SHIFT = 6;
+
+/** ***************************************************************************
+ * @brief one level of the block summary pyramid. Each tile at this level
+ * covers a square of 2^shift pixels on a side, clipped to the image edges.
+ *****************************************************************************/
+struct summaryLevel
+{
+    int rows; /*!< the number of rows of tiles at this level */
+    int cols; /*!< the number of columns of tiles at this level */
+    int shift; /*!< log2 of the edge length in pixels of a tile */
+    pixel **uniform; /*!< a 2d array holding 1 if every pixel of the tile is
+                     the same color and 0 otherwise */
+    pixel **red; /*!< a 2d array containing the red value of uniform tiles */
+    pixel **green; /*!< a 2d array containing the green value of uniform
+                   tiles */
+    pixel **blue; /*!< a 2d array containing the blue value of uniform tiles */
+};
+
+/** ***************************************************************************
+ * @brief block summary structure holds a pyramid of tile levels, from the
+ * 64x64 tiles at level 0 up to a single tile covering the whole image.
+ *****************************************************************************/
+struct blockSummary
+{
+    int levels; /*!< the number of levels in the pyramid */
+    summaryLevel *level; /*!< the array of levels, finest first */
+};
+
 /******************************************************************************
  *                         Function Prototypes
  *****************************************************************************/
@@ -45,10 +80,19 @@ void cfill( image &specifications, int row, int col, pixel newred,
             pixel newgreen, pixel newblue, pixel prevred, pixel prevblue,
             pixel prevgreen );
 
+// block summary and the fill which uses it
+void bfill( image &specifications, blockSummary &summary, int row, int col,
+            pixel newred, pixel newgreen, pixel newblue );
+void buildSummary( image &specifications, blockSummary &summary );
+void refreshTile( image &specifications, blockSummary &summary, int level,
+                  int tileRow, int tileCol );
+void refreshAncestors( image &specifications, blockSummary &summary,
+                       int level, int tileRow, int tileCol );
+
 // direct operations and output at usage statement
 void usageStatement( );
 void validateArgs( int argc, char *argv[], int &row, int &col, pixel &red,
-                   pixel &green, pixel &blue );
+                   pixel &green, pixel &blue, bool &useBlocks );
 void read( fstream &imageFile, image &specifications, int argc, char *argv[] );
 void write( fstream &writeFile, image &specifications, int argc,
             char *argv[] );
@@ -63,5 +107,7 @@ void writeBinary( fstream &writeFile, image specifications );
 // memory
 void allocArray( pixel **&color, int rows, int cols );
 void free2d( pixel **&color, int rows );
+void allocSummary( blockSummary &summary, int rows, int cols );
+void freeSummary( blockSummary &summary );
 
 #endif
@@ -0,0 +1,458 @@
+/** ***************************************************************************
+* @file
+*
+* @brief contains functions which build and maintain the block summary
+* pyramid, and the flood fill which uses it to skip uniform areas in bulk
+******************************************************************************/
+#include "netPBM.h"
+
+/** ***************************************************************************
+ * @brief fill job structure holds the state shared by the helpers of the
+ * block summary fill: the image, its summary, both colors, the pending seed
+ * pixels, and the level 0 tiles written pixel by pixel.
+ *****************************************************************************/
+struct fillJob
+{
+    image &specifications; /*!< the image being filled */
+    blockSummary &summary; /*!< the block summary of the image */
+    pixel newred; /*!< the new red value for the region */
+    pixel newgreen; /*!< the new green value for the region */
+    pixel newblue; /*!< the new blue value for the region */
+    pixel prevred; /*!< the origional red value of the region */
+    pixel prevgreen; /*!< the origional green value of the region */
+    pixel prevblue; /*!< the origional blue value of the region */
+    vector<int> seeds; /*!< pending seed pixels as row, column pairs */
+    vector<int> dirty; /*!< level 0 tiles to refresh as row, column pairs */
+    pixel **isDirty; /*!< a 2d array holding 1 for tiles already in dirty */
+};
+
+/** ***************************************************************************
+ * @author Cameron Custer
+ *
+ * @par Description:
+ * This function checks whether the pixel at the given row and column still
+ * has the origional color of the region being filled.
+ *
+ * @param[in] job - the fill job containing the image and the origional color
+ * @param[in] row - the row of the pixel to check
+ * @param[in] col - the column of the pixel to check
+ *
+ * @returns true if the pixel has the origional color, false otherwise
+ *****************************************************************************/
+static bool isPrev( fillJob &job, int row, int col )
+{
+    return job.specifications.red[row][col] == job.prevred &&
+        job.specifications.green[row][col] == job.prevgreen &&
+        job.specifications.blue[row][col] == job.prevblue;
+}
+
+/** ***************************************************************************
+ * @author Cameron Custer
+ *
+ * @par Description:
+ * This function walks a horizontal or vertical line of pixels and pushes a
+ * seed for the start of every run of pixels with the origional color. Level 0
+ * tiles which are uniform are stepped over in one move, so only a single seed
+ * is pushed per uniform tile the line crosses.
+ *
+ * @param[in, out] job - the fill job to push the seeds onto
+ * @param[in] row - the row of the first pixel of the line
+ * @param[in] col - the column of the first pixel of the line
+ * @param[in] vertical - true to walk down the rows, false to walk across
+ * the columns
+ * @param[in] length - the number of pixels in the line
+ *
+ * @returns None
+ *****************************************************************************/
+static void seedLine( fillJob &job, int row, int col, bool vertical,
+                      int length )
+{
+    summaryLevel &tiles = job.summary.level[0];
+    bool inRun = false;
+    int i = 0;
+    int r, c, step;
+
+    while( i < length )
+    {
+        r = vertical ? row + i : row;
+        c = vertical ? col : col + i;
+
+        // a uniform tile is either all origional color or none of it
+        if( tiles.uniform[r >> BLOCK_SHIFT][c >> BLOCK_SHIFT] )
+        {
+            inRun = isPrev( job, r, c );
+            if( inRun )
+            {
+                job.seeds.push_back( r );
+                job.seeds.push_back( c );
+            }
+            // step to the first pixel past the tile along the line
+            if( vertical )
+                step = ( ( ( r >> BLOCK_SHIFT ) + 1 ) << BLOCK_SHIFT ) - r;
+            else
+                step = ( ( ( c >> BLOCK_SHIFT ) + 1 ) << BLOCK_SHIFT ) - c;
+            i += step;
+            continue;
+        }
+
+        // otherwise seed the first pixel of each run
+        if( isPrev( job, r, c ) )
+        {
+            if( !inRun )
+            {
+                job.seeds.push_back( r );
+                job.seeds.push_back( c );
+            }
+            inRun = true;
+        }
+        else
+            inRun = false;
+        i++;
+    }
+}
+
+/** ***************************************************************************
+ * @author Cameron Custer
+ *
+ * @par Description:
+ * This function recolors a whole uniform tile with one bulk store per row of
+ * each color array. Every tile below it in the pyramid is marked uniform in
+ * the new color, the tiles above it are refreshed, and seeds are pushed along
+ * the four lines of pixels just outside its edges.
+ *
+ * @param[in, out] job - the fill job containing the image and its summary
+ * @param[in] level - the level of the tile in the pyramid
+ * @param[in] tileRow - the row of the tile at that level
+ * @param[in] tileCol - the column of the tile at that level
+ *
+ * @returns None
+ *****************************************************************************/
+static void fillTile( fillJob &job, int level, int tileRow, int tileCol )
+{
+    image &specifications = job.specifications;
+    int shift = job.summary.level[level].shift;
+    int top = tileRow << shift;
+    int left = tileCol << shift;
+    int bottom = min( top + ( 1 << shift ), specifications.rows );
+    int right = min( left + ( 1 << shift ), specifications.cols );
+    int i, j, k, up, down, first, last;
+
+    // bulk store the new color over every row of the tile
+    for( i = top; i < bottom; i++ )
+    {
+        memset( specifications.red[i] + left, job.newred, right - left );
+        memset( specifications.green[i] + left, job.newgreen, right - left );
+        memset( specifications.blue[i] + left, job.newblue, right - left );
+    }
+
+    // mark the tile and every tile beneath it uniform in the new color
+    for( k = level; k >= 0; k-- )
+    {
+        summaryLevel &tiles = job.summary.level[k];
+        up = tileRow << ( level - k );
+        down = min( ( tileRow + 1 ) << ( level - k ), tiles.rows );
+        first = tileCol << ( level - k );
+        last = min( ( tileCol + 1 ) << ( level - k ), tiles.cols );
+        for( i = up; i < down; i++ )
+        {
+            for( j = first; j < last; j++ )
+            {
+                tiles.uniform[i][j] = 1;
+                tiles.red[i][j] = job.newred;
+                tiles.green[i][j] = job.newgreen;
+                tiles.blue[i][j] = job.newblue;
+            }
+        }
+    }
+    refreshAncestors( specifications, job.summary, level, tileRow, tileCol );
+
+    // seed the pixels bordering each edge of the tile
+    if( top > 0 )
+        seedLine( job, top - 1, left, false, right - left );
+    if( bottom < specifications.rows )
+        seedLine( job, bottom, left, false, right - left );
+    if( left > 0 )
+        seedLine( job, top, left - 1, true, bottom - top );
+    if( right < specifications.cols )
+        seedLine( job, top, right, true, bottom - top );
+}
+
+/** ***************************************************************************
+ * @author Cameron Custer
+ *
+ * @par Description:
+ * This function fills the horizontal span of origional color pixels through
+ * the seed pixel, which lies in a tile that is not uniform. The span stops at
+ * the first uniform tile on either side, leaving a seed there so the tile is
+ * filled in bulk instead. The tiles the span touches are queued to have their
+ * summary refreshed once the fill is done, and the rows above and below the
+ * span are seeded.
+ *
+ * @param[in, out] job - the fill job containing the image and its summary
+ * @param[in] row - the row of the seed pixel
+ * @param[in] col - the column of the seed pixel
+ *
+ * @returns None
+ *****************************************************************************/
+static void fillSpan( fillJob &job, int row, int col )
+{
+    image &specifications = job.specifications;
+    pixel **uniform = job.summary.level[0].uniform;
+    int tileRow = row >> BLOCK_SHIFT;
+    int left = col;
+    int right = col;
+    int i;
+
+    // extend the span left and right until the color or a uniform tile ends
+    while( left > 0 && isPrev( job, row, left - 1 ) )
+    {
+        if( uniform[tileRow][( left - 1 ) >> BLOCK_SHIFT] )
+        {
+            job.seeds.push_back( row );
+            job.seeds.push_back( left - 1 );
+            break;
+        }
+        left--;
+    }
+    while( right < specifications.cols - 1 && isPrev( job, row, right + 1 ) )
+    {
+        if( uniform[tileRow][( right + 1 ) >> BLOCK_SHIFT] )
+        {
+            job.seeds.push_back( row );
+            job.seeds.push_back( right + 1 );
+            break;
+        }
+        right++;
+    }
+
+    // store the new color over the span
+    memset( specifications.red[row] + left, job.newred, right - left + 1 );
+    memset( specifications.green[row] + left, job.newgreen, right - left + 1 );
+    memset( specifications.blue[row] + left, job.newblue, right - left + 1 );
+
+    // queue each tile the span touched for a refresh
+    for( i = left >> BLOCK_SHIFT; i <= right >> BLOCK_SHIFT; i++ )
+    {
+        if( !job.isDirty[tileRow][i] )
+        {
+            job.isDirty[tileRow][i] = 1;
+            job.dirty.push_back( tileRow );
+            job.dirty.push_back( i );
+        }
+    }
+
+    // seed the rows above and below the span
+    if( row > 0 )
+        seedLine( job, row - 1, left, false, right - left + 1 );
+    if( row < specifications.rows - 1 )
+        seedLine( job, row + 1, left, false, right - left + 1 );
+}
+
+/** ***************************************************************************
+ * @author Cameron Custer
+ *
+ * @par Description:
+ * This is the block summary version of the cfill function. Rather than
+ * visiting every pixel of the region one at a time, it looks up the coarsest
+ * uniform tile in the pyramid holding each seed pixel and recolors the whole
+ * tile with bulk stores. Only seeds in tiles that are not uniform, which lie
+ * along the boundary of the region, are filled span by span. The seeds are
+ * kept on an explicit stack so the fill does not recurse.
+ *
+ * The summary is kept correct as the image is modified: bulk filled tiles
+ * are updated as they are stored, and tiles filled span by span are rescanned
+ * once the fill is done.
+ *
+ * @param[in, out] specifications - the structure containing the image data for
+ * all three of the color arrays to be modified ( red, green, blue )
+ * @param[in, out] summary - the block summary of the image, built by
+ * buildSummary
+ * @param[in] row - the row of the starting pixel
+ * @param[in] col - the column of the starting pixel
+ * @param[in] newred - the new red value for the region
+ * @param[in] newgreen - the new green value for the region
+ * @param[in] newblue - the new blue value for the region
+ *
+ * @returns None
+ *****************************************************************************/
+void bfill( image &specifications, blockSummary &summary, int row, int col,
+            pixel newred, pixel newgreen, pixel newblue )
+{
+    fillJob job = { specifications, summary, newred, newgreen, newblue,
+                    specifications.red[row][col],
+                    specifications.green[row][col],
+                    specifications.blue[row][col] };
+    int level, tileRow, tileCol;
+    size_t i;
+    int j;
+
+    // nothing to change if the region already has the new color
+    if( job.prevred == newred && job.prevgreen == newgreen &&
+        job.prevblue == newblue )
+        return;
+
+    allocArray( job.isDirty, summary.level[0].rows, summary.level[0].cols );
+    for( j = 0; j < summary.level[0].rows; j++ )
+        memset( job.isDirty[j], 0, summary.level[0].cols );
+
+    job.seeds.push_back( row );
+    job.seeds.push_back( col );
+    while( !job.seeds.empty( ) )
+    {
+        col = job.seeds.back( );
+        job.seeds.pop_back( );
+        row = job.seeds.back( );
+        job.seeds.pop_back( );
+
+        // skip seeds already filled since they were pushed
+        if( !isPrev( job, row, col ) )
+            continue;
+
+        if( !summary.level[0].uniform[row >> BLOCK_SHIFT][col >> BLOCK_SHIFT] )
+        {
+            fillSpan( job, row, col );
+            continue;
+        }
+
+        // climb to the coarsest uniform tile holding the seed
+        level = 0;
+        while( level + 1 < summary.levels &&
+               summary.level[level + 1].uniform
+                   [row >> summary.level[level + 1].shift]
+                   [col >> summary.level[level + 1].shift] )
+            level++;
+        tileRow = row >> summary.level[level].shift;
+        tileCol = col >> summary.level[level].shift;
+        fillTile( job, level, tileRow, tileCol );
+    }
+
+    // rescan the tiles filled span by span now that the fill is done
+    for( i = 0; i < job.dirty.size( ); i += 2 )
+    {
+        refreshTile( specifications, summary, 0, job.dirty[i],
+                     job.dirty[i + 1] );
+        refreshAncestors( specifications, summary, 0, job.dirty[i],
+                          job.dirty[i + 1] );
+    }
+
+    free2d( job.isDirty, summary.level[0].rows );
+}
+
+/** ***************************************************************************
+ * @author Cameron Custer
+ *
+ * @par Description:
+ * This function builds the block summary pyramid for an image after its
+ * data has been read. The level 0 tiles are scanned from the pixels, and
+ * each coarser level is combined from the level beneath it.
+ *
+ * @param[in] specifications - the structure containing the image data
+ * @param[in, out] summary - the block summary to allocate and build
+ *
+ * @returns None
+ *****************************************************************************/
+void buildSummary( image &specifications, blockSummary &summary )
+{
+    int level, i, j;
+
+    allocSummary( summary, specifications.rows, specifications.cols );
+
+    // refresh every tile, finest level first
+    for( level = 0; level < summary.levels; level++ )
+        for( i = 0; i < summary.level[level].rows; i++ )
+            for( j = 0; j < summary.level[level].cols; j++ )
+                refreshTile( specifications, summary, level, i, j );
+}
+
+/** ***************************************************************************
+ * @author Cameron Custer
+ *
+ * @par Description:
+ * This function recomputes whether a single tile is uniform and which color
+ * it is. A level 0 tile is scanned from the pixels of the image. A tile at a
+ * coarser level is uniform only if each of the tiles beneath it is uniform
+ * in the same color.
+ *
+ * @param[in] specifications - the structure containing the image data
+ * @param[in, out] summary - the block summary containing the tile
+ * @param[in] level - the level of the tile in the pyramid
+ * @param[in] tileRow - the row of the tile at that level
+ * @param[in] tileCol - the column of the tile at that level
+ *
+ * @returns None
+ *****************************************************************************/
+void refreshTile( image &specifications, blockSummary &summary, int level,
+                  int tileRow, int tileCol )
+{
+    summaryLevel &tiles = summary.level[level];
+    pixel red, green, blue;
+    bool uniform = true;
+    int top, left, bottom, right;
+    int i, j;
+
+    if( level == 0 )
+    {
+        // compare every pixel of the tile against its first pixel
+        top = tileRow << BLOCK_SHIFT;
+        left = tileCol << BLOCK_SHIFT;
+        bottom = min( top + ( 1 << BLOCK_SHIFT ), specifications.rows );
+        right = min( left + ( 1 << BLOCK_SHIFT ), specifications.cols );
+        red = specifications.red[top][left];
+        green = specifications.green[top][left];
+        blue = specifications.blue[top][left];
+        for( i = top; i < bottom && uniform; i++ )
+            for( j = left; j < right && uniform; j++ )
+                uniform = specifications.red[i][j] == red &&
+                    specifications.green[i][j] == green &&
+                    specifications.blue[i][j] == blue;
+    }
+    else
+    {
+        // compare every tile beneath against the first tile beneath
+        summaryLevel &below = summary.level[level - 1];
+        top = tileRow * 2;
+        left = tileCol * 2;
+        bottom = min( top + 2, below.rows );
+        right = min( left + 2, below.cols );
+        red = below.red[top][left];
+        green = below.green[top][left];
+        blue = below.blue[top][left];
+        for( i = top; i < bottom && uniform; i++ )
+            for( j = left; j < right && uniform; j++ )
+                uniform = below.uniform[i][j] && below.red[i][j] == red &&
+                    below.green[i][j] == green && below.blue[i][j] == blue;
+    }
+
+    tiles.uniform[tileRow][tileCol] = uniform;
+    tiles.red[tileRow][tileCol] = red;
+    tiles.green[tileRow][tileCol] = green;
+    tiles.blue[tileRow][tileCol] = blue;
+}
+
+/** ***************************************************************************
+ * @author Cameron Custer
+ *
+ * @par Description:
+ * This function refreshes every tile above the given tile in the pyramid,
+ * from its parent up to the single tile covering the whole image. It is
+ * called whenever a tile changes so the coarser levels stay correct.
+ *
+ * @param[in] specifications - the structure containing the image data
+ * @param[in, out] summary - the block summary containing the tile
+ * @param[in] level - the level of the tile which changed
+ * @param[in] tileRow - the row of the tile at that level
+ * @param[in] tileCol - the column of the tile at that level
+ *
+ * @returns None
+ *****************************************************************************/
+void refreshAncestors( image &specifications, blockSummary &summary,
+                       int level, int tileRow, int tileCol )
+{
+    // walk up one level at a time, halving the tile position
+    for( level++; level < summary.levels; level++ )
+    {
+        tileRow /= 2;
+        tileCol /= 2;
+        refreshTile( specifications, summary, level, tileRow, tileCol );
+    }
+}
@@ -30,6 +30,13 @@
  * pixel. The cfill functions stops when either another color is reached or
  * the edge of the image is reached.
  *
+ * For images with large flat areas the optional block summary may be used
+ * instead. A pyramid recording which 64x64 tiles ( and coarser tiles ) are a
+ * single color is built when the image is read. The bfill function then
+ * recolors whole uniform tiles at once and only works pixel by pixel along
+ * the boundary of the region, so the cost of the fill scales with the length
+ * of the boundary rather than the area of the region.
+ *
  * Once the pixels have been modified the image is output to overwrite
  * the origional image data contianed in the file. The image now contains
  * the modificaitons made by the cfill function and is stored for viewing.
@@ -42,8 +49,9 @@
  *
  * @par Usage
    @verbatim
-   C:\> floodfill image.ppm starting_row starting_column new_red_value new_green_value new_blue_value
+   C:\> floodfill image.ppm starting_row starting_column new_red_value new_green_value new_blue_value [-b]
    @endverbatim
+ *      The optional -b flag fills using the block summary.
  *
  * @section todo_bugs_modification_section Todo, Bugs, and Modifications
  *
@@ -76,11 +84,13 @@ int main( int argc, char *argv[] )
     // declarations
     fstream imageFile;
     image specifications;
+    blockSummary summary;
     int row, col;
     pixel red, green, blue, prevred, prevgreen, prevblue;
+    bool useBlocks;
 
     // check for proper amount of arguments
-    if( argc != 7 )
+    if( argc != 7 && argc != 8 )
         usageStatement( );
 
     // open the image and verify
@@ -92,7 +102,7 @@ int main( int argc, char *argv[] )
     }
 
     // validate command line arguments
-    validateArgs( argc, argv, row, col, red, green, blue );
+    validateArgs( argc, argv, row, col, red, green, blue, useBlocks );
 
     // read the image header
     readImageHeader( imageFile, specifications );
@@ -100,14 +110,24 @@ int main( int argc, char *argv[] )
     // read the image data into the 2 dimensional arrays
     read( imageFile, specifications, argc, argv );
 
-    // initialize the previous values of the pixel
-    prevred = specifications.red[row][col];
-    prevgreen = specifications.green[row][col];
-    prevblue = specifications.blue[row][col];
-
-    // perform the cfill starting at the current pixel on the image
-    cfill( specifications, row, col, red, green, blue, prevred, prevgreen,
-           prevblue );
+    if( useBlocks )
+    {
+        // summarize the uniform tiles and fill them in bulk
+        buildSummary( specifications, summary );
+        bfill( specifications, summary, row, col, red, green, blue );
+        freeSummary( summary );
+    }
+    else
+    {
+        // initialize the previous values of the pixel
+        prevred = specifications.red[row][col];
+        prevgreen = specifications.green[row][col];
+        prevblue = specifications.blue[row][col];
+
+        // perform the cfill starting at the current pixel on the image
+        cfill( specifications, row, col, red, green, blue, prevred,
+               prevgreen, prevblue );
+    }
 
     // write the modified image data containing the cfill
     // over the origional image data
@@ -183,7 +203,8 @@ void cfill( image &specifications, int row, int col, pixel newred,
  *
  * @par Description:
  * This function initializes the values of the row, column, red, green, and
- * blue values as specified by the command line. This functions has no
+ * blue values as specified by the command line, and whether the optional -b
+ * flag asked for the block summary fill. This functions has no
  * returns becuase all of the intialized values are passed by refrence. The
  * command line arguments are also passed into this function and typecasted as
  * strings so that the data may be extracted.
@@ -197,11 +218,12 @@ void cfill( image &specifications, int row, int col, pixel newred,
  * @param[in, out] red - the new red pixel value
  * @param[in, out] green - the new green pixel value
  * @param[in, out] blue - the new blue pixel value
+ * @param[in, out] useBlocks - true if the fill should use the block summary
  *
  * @returns none
  *****************************************************************************/
 void validateArgs( int argc, char *argv[], int &row, int &col, pixel &red,
-                   pixel &green, pixel &blue )
+                   pixel &green, pixel &blue, bool &useBlocks )
 {
     // store command line arguments 2-6
     row = stoi( (string) argv[2] );
@@ -209,4 +231,13 @@ void validateArgs( int argc, char *argv[], int &row, int &col, pixel &red,
     red = stoi( (string) argv[4] );
     green = stoi( (string) argv[5] );
     blue = stoi( (string) argv[6] );
+
+    // the optional 7th argument selects the block summary fill
+    useBlocks = false;
+    if( argc == 8 )
+    {
+        if( (string) argv[7] != "-b" )
+            usageStatement( );
+        useBlocks = true;
+    }
 }
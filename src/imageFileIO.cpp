@@ -18,7 +18,7 @@
 void usageStatement( )
 {
     cout <<
-        "floodfill image.ppm starting_row starting_column new_red_value new_green_value new_blue_value"
+        "floodfill image.ppm starting_row starting_column new_red_value new_green_value new_blue_value [-b]"
         << endl;
     // exit without fail
     exit( 0 );
@@ -68,3 +68,78 @@ void free2d( pixel **&color, int rows )
         delete[] color[i];
     delete[] color;
 }
+
+/** ***************************************************************************
+ * @author Cameron Custer
+ *
+ * @par Description:
+ * This function dynamically allocates the levels of a block summary pyramid
+ * for an image of the given size. Level 0 holds one tile for every 64x64
+ * square of the image and each following level halves the number of rows and
+ * columns of tiles until a single tile covers the whole image. The contents
+ * of the tiles are left for buildSummary to fill in.
+ *
+ * @param[in, out] summary - the block summary to allocate the levels of
+ * @param[in] rows - an intiger representing the number of rows in the image
+ * @param[in] cols - an intiger representing the number of columns in the
+ * image
+ *
+ * @returns none
+ *****************************************************************************/
+void allocSummary( blockSummary &summary, int rows, int cols )
+{
+    int i;
+    int tileRows = ( rows + ( 1 << BLOCK_SHIFT ) - 1 ) >> BLOCK_SHIFT;
+    int tileCols = ( cols + ( 1 << BLOCK_SHIFT ) - 1 ) >> BLOCK_SHIFT;
+
+    // count the levels needed to reach a single tile
+    summary.levels = 1;
+    for( i = max( tileRows, tileCols ); i > 1; i = ( i + 1 ) / 2 )
+        summary.levels++;
+
+    summary.level = new ( nothrow ) summaryLevel[summary.levels];
+    if( summary.level == nullptr )
+        usageStatement( );
+
+    // allocate the tile arrays for each level, halving as we go up
+    for( i = 0; i < summary.levels; i++ )
+    {
+        summary.level[i].rows = tileRows;
+        summary.level[i].cols = tileCols;
+        summary.level[i].shift = BLOCK_SHIFT + i;
+        allocArray( summary.level[i].uniform, tileRows, tileCols );
+        allocArray( summary.level[i].red, tileRows, tileCols );
+        allocArray( summary.level[i].green, tileRows, tileCols );
+        allocArray( summary.level[i].blue, tileRows, tileCols );
+
+        tileRows = ( tileRows + 1 ) / 2;
+        tileCols = ( tileCols + 1 ) / 2;
+    }
+}
+
+/** ***************************************************************************
+ * @author Cameron Custer
+ *
+ * @par Description:
+ * This function frees the memory from every level of a block summary
+ * pyramid, and then the array of levels itself.
+ *
+ * @param[in, out] summary - the block summary to clear
+ *
+ * @returns none
+ *****************************************************************************/
+void freeSummary( blockSummary &summary )
+{
+    int i;
+    // free the tile arrays of each level
+    for( i = 0; i < summary.levels; i++ )
+    {
+        free2d( summary.level[i].uniform, summary.level[i].rows );
+        free2d( summary.level[i].red, summary.level[i].rows );
+        free2d( summary.level[i].green, summary.level[i].rows );
+        free2d( summary.level[i].blue, summary.level[i].rows );
+    }
+    delete[] summary.level;
+    summary.level = nullptr;
+    summary.levels = 0;
+}